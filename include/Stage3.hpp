@@ -4,6 +4,7 @@
 #include <opencv2/opencv.hpp>
 #include <opencv2/dnn.hpp>
 #include "utils.hpp"
+#include <future>
 #include <string>
 #include <vector>
 
@@ -31,11 +32,17 @@ private:
         std::vector<cv::Point> contour_points;
     };
 
+    void startYoloInitialization();
+    bool waitForYoloInitialization(const cv::Size& warmup_input_size);
     bool initializeYoloDetector();
+    bool loadYoloNetwork();
+    void warmUpYoloDetector(const cv::Size& input_size);
     bool loadYoloShapeClasses(const std::string& filename);
     Stage3Engagement generateRandomEngagement();
     int determineDominantColorID(const cv::Mat& frame_hsv, const cv::Rect& roi);
     std::vector<cv::String> getYoloOutputLayerNames();
+    cv::Rect getInferenceRoi(const cv::Size& frame_size, int board_side) const;
+    cv::Size getYoloInputSize(const cv::Size& roi_size) const;
 
     cv::dnn::Net yolo_detection_net;
     std::vector<std::string> yolo_shape_classes;
@@ -43,10 +50,24 @@ private:
     const float NMS_THRESHOLD = 0.4f;
     const int YOLO_INPUT_WIDTH = 416;
     const int YOLO_INPUT_HEIGHT = 416;
+    const int YOLO_WARMUP_RUNS = 2;
+
+    // Engagement crop: infer only on the commanded board half plus a margin
+    // (fraction of frame width) so targets near the center line are not cut
+    const float ENGAGEMENT_CROP_MARGIN = 0.1f;
+    bool use_engagement_crop = true;
 
     std::string yolo_model_weights_path;
     std::string yolo_model_cfg_path;
     std::string yolo_class_names_path;
+
+    // Detector is loaded once per Stage3 instance and reused across run() calls
+    std::vector<cv::String> yolo_output_layer_names;
+    bool is_yolo_ready = false;
+    cv::Size yolo_net_input_size;  // Input shape the net is currently allocated for
+    std::promise<cv::Size> yolo_warmup_size_promise;
+    std::future<cv::Size> yolo_warmup_size_future;
+    std::future<bool> yolo_init_future;
 };
 
 #endif // STAGE3_HPP
\ No newline at end of file
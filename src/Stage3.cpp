@@ -4,6 +4,7 @@
 #include <random>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
 
 Stage3::Stage3() {
     yolo_model_weights_path = "yolov4-tiny.weights";
@@ -11,32 +12,96 @@ Stage3::Stage3() {
     yolo_class_names_path = "coco.names";
 }
 
+void Stage3::startYoloInitialization() {
+    if (is_yolo_ready || yolo_init_future.valid()) return;
+    yolo_warmup_size_promise = std::promise<cv::Size>();
+    yolo_warmup_size_future = yolo_warmup_size_promise.get_future();
+    yolo_init_future = std::async(std::launch::async, &Stage3::initializeYoloDetector, this);
+}
+
+bool Stage3::waitForYoloInitialization(const cv::Size& warmup_input_size) {
+    if (!is_yolo_ready) {
+        // Hand the warm-up shape to the background task; it always needs a value to finish
+        startYoloInitialization();
+        yolo_warmup_size_promise.set_value(warmup_input_size);
+        is_yolo_ready = yolo_init_future.get();
+        return is_yolo_ready;
+    }
+
+    // Loaded on an earlier run; nothing is left to overlap, so re-warm here if the shape changed
+    if (warmup_input_size.area() > 0 && warmup_input_size != yolo_net_input_size) {
+        warmUpYoloDetector(warmup_input_size);
+    }
+    return true;
+}
+
 bool Stage3::initializeYoloDetector() {
     std::cout << "Initializing YOLO...\n";
-    
+    auto start_time = std::chrono::steady_clock::now();
+
+    // Class names are cheap to load; fail on them before paying for the network
+    if (!loadYoloShapeClasses(yolo_class_names_path)) {
+        return false;
+    }
+
+    if (!loadYoloNetwork()) {
+        return false;
+    }
+
+    // Force CPU usage
+    yolo_detection_net.setPreferableBackend(cv::dnn::DNN_BACKEND_DEFAULT);
+    yolo_detection_net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+    yolo_output_layer_names = getYoloOutputLayerNames();
+
+    // Warm-up waits for run() to report the camera's input shape; an empty size skips it
+    cv::Size warmup_input_size = yolo_warmup_size_future.get();
+    if (warmup_input_size.area() > 0) {
+        warmUpYoloDetector(warmup_input_size);
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    std::cout << "YOLO ready in " << elapsed.count() << " ms\n";
+    return true;
+}
+
+bool Stage3::loadYoloNetwork() {
     // Check if files exist
     std::ifstream cfg_file(yolo_model_cfg_path);
     std::ifstream weights_file(yolo_model_weights_path);
-    
+
     if (!cfg_file.good() || !weights_file.good()) {
         std::cerr << "ERROR: YOLO model files not found!\n";
         return false;
     }
-    
+
     cfg_file.close();
     weights_file.close();
 
+    // No pre-converted model format: OpenCV cannot serialize a loaded Net, so the
+    // Darknet files are parsed on every start. The background load hides that cost.
     yolo_detection_net = cv::dnn::readNetFromDarknet(yolo_model_cfg_path, yolo_model_weights_path);
     if (yolo_detection_net.empty()) {
         std::cerr << "ERROR: Could not load YOLO model!\n";
         return false;
     }
+    return true;
+}
 
-    // Force CPU usage
-    yolo_detection_net.setPreferableBackend(cv::dnn::DNN_BACKEND_DEFAULT);
-    yolo_detection_net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
-    
-    return loadYoloShapeClasses(yolo_class_names_path);
+void Stage3::warmUpYoloDetector(const cv::Size& input_size) {
+    // The first forward passes allocate layer buffers; pay for that before the first real frame.
+    // A blob of a different shape drops the allocation, so only one shape can be kept warm.
+    cv::Mat dummy_frame(input_size.height, input_size.width, CV_8UC3, cv::Scalar(0,0,0));
+    cv::Mat dummy_blob;
+    cv::dnn::blobFromImage(dummy_frame, dummy_blob, 1/255.0, input_size,
+        cv::Scalar(0,0,0), true, false);
+
+    std::vector<cv::Mat> outs;
+    for (int i = 0; i < YOLO_WARMUP_RUNS; ++i) {
+        yolo_detection_net.setInput(dummy_blob);
+        yolo_detection_net.forward(outs, yolo_output_layer_names);
+    }
+    yolo_net_input_size = input_size;
 }
 
 bool Stage3::loadYoloShapeClasses(const std::string& filename) {
@@ -46,6 +111,7 @@ bool Stage3::loadYoloShapeClasses(const std::string& filename) {
         return false;
     }
 
+    yolo_shape_classes.clear();
     std::string line;
     while (std::getline(ifs, line)) {
         yolo_shape_classes.push_back(line);
@@ -75,6 +141,34 @@ std::vector<cv::String> Stage3::getYoloOutputLayerNames() {
     return names;
 }
 
+cv::Rect Stage3::getInferenceRoi(const cv::Size& frame_size, int board_side) const {
+    if (!use_engagement_crop) {
+        return cv::Rect(0, 0, frame_size.width, frame_size.height);
+    }
+
+    int frame_middle_x = frame_size.width / 2;
+    int margin = static_cast<int>(frame_size.width * ENGAGEMENT_CROP_MARGIN);
+
+    if (board_side == 0) {
+        int right = std::min(frame_middle_x + margin, frame_size.width);
+        return cv::Rect(0, 0, right, frame_size.height);
+    }
+    int left = std::max(frame_middle_x - margin, 0);
+    return cv::Rect(left, 0, frame_size.width - left, frame_size.height);
+}
+
+cv::Size Stage3::getYoloInputSize(const cv::Size& roi_size) const {
+    if (!use_engagement_crop) {
+        return cv::Size(YOLO_INPUT_WIDTH, YOLO_INPUT_HEIGHT);
+    }
+
+    // Keep the input height and follow the crop's aspect ratio, snapped to YOLO's 32px stride
+    double aspect = static_cast<double>(roi_size.width) / roi_size.height;
+    int width = static_cast<int>(std::round(YOLO_INPUT_HEIGHT * aspect / 32.0)) * 32;
+    width = std::max(32, std::min(width, YOLO_INPUT_WIDTH));
+    return cv::Size(width, YOLO_INPUT_HEIGHT);
+}
+
 Stage3::Stage3Engagement Stage3::generateRandomEngagement() {
     static std::mt19937 rng(std::chrono::steady_clock::now().time_since_epoch().count());
     std::uniform_int_distribution<int> board_dist(0, 1);
@@ -91,14 +185,31 @@ Stage3::Stage3Engagement Stage3::generateRandomEngagement() {
 }
 
 void Stage3::run() {
-    if (!initializeYoloDetector()) {
-        std::cerr << "Stage 3 initialization failed!\n";
-        return;
-    }
+    // Every run starts in engagement crop mode, regardless of earlier toggles
+    use_engagement_crop = true;
+
+    // Load the detector in the background while the camera opens
+    startYoloInitialization();
 
     cv::VideoCapture cap(0);
     if (!cap.isOpened()) {
         std::cerr << "Could not open camera!\n";
+        // Let the background load finish without a warm-up so the next run can reuse it
+        waitForYoloInitialization(cv::Size());
+        return;
+    }
+
+    // Warm up for the input shape of the first frame. The engagement is not drawn yet, but
+    // the two board halves differ by at most one pixel, which the 32px input stride absorbs.
+    cv::Size camera_size(static_cast<int>(cap.get(cv::CAP_PROP_FRAME_WIDTH)),
+                         static_cast<int>(cap.get(cv::CAP_PROP_FRAME_HEIGHT)));
+    cv::Size warmup_input_size;
+    if (camera_size.width > 0 && camera_size.height > 0) {
+        warmup_input_size = getYoloInputSize(getInferenceRoi(camera_size, 0).size());
+    }
+
+    if (!waitForYoloInitialization(warmup_input_size)) {
+        std::cerr << "Stage 3 initialization failed!\n";
         return;
     }
 
@@ -114,14 +225,18 @@ void Stage3::run() {
         cap >> frame;
         if (frame.empty()) break;
 
+        // Restrict inference to the commanded board half when cropping is enabled
+        cv::Rect inference_roi = getInferenceRoi(frame.size(), current_order.board_side);
+        cv::Size input_size = getYoloInputSize(inference_roi.size());
+
         // Create blob for YOLO
-        cv::dnn::blobFromImage(frame, blob, 1/255.0, 
-            cv::Size(YOLO_INPUT_WIDTH, YOLO_INPUT_HEIGHT),
-            cv::Scalar(0,0,0), true, false);
+        cv::dnn::blobFromImage(frame(inference_roi), blob, 1/255.0,
+            input_size, cv::Scalar(0,0,0), true, false);
         
         yolo_detection_net.setInput(blob);
         std::vector<cv::Mat> outs;
-        yolo_detection_net.forward(outs, getYoloOutputLayerNames());
+        yolo_detection_net.forward(outs, yolo_output_layer_names);
+        yolo_net_input_size = input_size;
 
         std::vector<int> class_ids;
         std::vector<float> confidences;
@@ -135,10 +250,11 @@ void Stage3::run() {
                 cv::minMaxLoc(scores, nullptr, &confidence, nullptr, &class_id_point);
 
                 if (confidence > MIN_YOLO_CONFIDENCE) {
-                    int centerX = static_cast<int>(out.at<float>(i, 0) * frame.cols);
-                    int centerY = static_cast<int>(out.at<float>(i, 1) * frame.rows);
-                    int width = static_cast<int>(out.at<float>(i, 2) * frame.cols);
-                    int height = static_cast<int>(out.at<float>(i, 3) * frame.rows);
+                    // Outputs are normalized to the inference ROI; map them back to the frame
+                    int centerX = inference_roi.x + static_cast<int>(out.at<float>(i, 0) * inference_roi.width);
+                    int centerY = inference_roi.y + static_cast<int>(out.at<float>(i, 1) * inference_roi.height);
+                    int width = static_cast<int>(out.at<float>(i, 2) * inference_roi.width);
+                    int height = static_cast<int>(out.at<float>(i, 3) * inference_roi.height);
                     int left = centerX - width/2;
                     int top = centerY - height/2;
 
@@ -197,6 +313,11 @@ void Stage3::run() {
                 cv::Point(frame_middle_x, frame.rows), 
                 cv::Scalar(100,100,100), 1);
 
+        // Inference region
+        if (use_engagement_crop) {
+            cv::rectangle(frame, inference_roi, cv::Scalar(255,255,0), 1);
+        }
+
         // Engagement info
         cv::putText(frame, "Engagement: " + current_order.description_text,
                     cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 0.6,
@@ -241,6 +362,11 @@ void Stage3::run() {
                 std::cout << "CANNOT FIRE: No target locked.\n";
             }
         }
+        if (key == 'c' || key == 'C') {
+            // Changes the input shape, so the next frame reallocates the network
+            use_engagement_crop = !use_engagement_crop;
+            std::cout << "Engagement crop: " << (use_engagement_crop ? "ON" : "OFF") << std::endl;
+        }
         if (key == 'n' || key == 'N') {
             current_order = generateRandomEngagement();
             std::cout << "MANUAL NEW ENGAGEMENT: " << current_order.description_text << std::endl;